@@ -0,0 +1,193 @@
+/*
+ * The coverage table and coverage file formats shared by codeCoverage,
+ * libInst and ccmerge.
+ *
+ * The coverage table describes every instrumented function and basic block.
+ * codeCoverage builds it while instrumenting and stores it as read-only data
+ * in the rewritten binary, so libInst needs no registration at startup. It is
+ * laid out so it can be used in place:
+ *
+ *   ccovHeader
+ *   ccovModule[numModules]
+ *   ccovFunc[numFuncs]
+ *   ccovBB[numBBs]
+ *   ccovImplied[numImplied]
+ *   strings                              NUL terminated, stringsSize bytes
+ *
+ * A coverage file is written by libInst in a single write at exit (or when
+ * the process dies from a fatal signal). It is the coverage table followed by
+ * the counts:
+ *
+ *   uint64_t counts[numFuncs + numBBs]   function counts, then block counts
+ *
+ * Every offset is from the start of the table, and the header and each array
+ * are 8 byte aligned. countsOffset is the size of the table.
+ *
+ * The feedback map is a shared memory object, named by CODECOVERAGE_SHM,
+ * that libInst marks as functions and blocks are hit so that another program
+ * (such as fleece -cov) can see which code each input reached while the
+ * instrumented program is still running. Function id i uses slot i and block
+ * id i uses slot numFuncs + i, modulo CCOV_FEEDBACK_MAP_SIZE. The first hit
+ * of a clear slot sets it and appends the slot number to the log; the
+ * reader resets nLogged after reading the log. A slot stays set until the
+ * reader clears it, so a reader that leaves covered slots set only sees the
+ * code no input reached before. When more than CCOV_FEEDBACK_LOG_SIZE slots
+ * are set between reads, the reader scans the whole map instead.
+ */
+
+#ifndef __CCOV_H__
+#define __CCOV_H__
+
+#include <stdint.h>
+#include <stdio.h>
+#include <map>
+#include <string>
+#include <vector>
+
+#define CCOV_MAGIC "CCOV002"
+
+// The counts are hit flags (0 or 1) rather than execution counts
+#define CCOV_HIT_ONLY 0x1
+
+// The table has basic block records
+#define CCOV_BLOCKS 0x2
+
+#define CCOV_FEEDBACK_MAGIC 0x42464343
+#define CCOV_FEEDBACK_MAP_SIZE (1 << 20)
+#define CCOV_FEEDBACK_LOG_SIZE 4096
+
+// This layout must match CoverageShm in fleece/h/CoverageMap.h
+struct ccovFeedback {
+    uint32_t magic;
+    uint32_t mapSize;
+    uint32_t nLogged;
+    uint32_t pad;
+    uint32_t log[CCOV_FEEDBACK_LOG_SIZE];
+    unsigned char map[CCOV_FEEDBACK_MAP_SIZE];
+};
+
+struct ccovHeader {
+    char magic[8];
+    uint32_t flags;
+    uint32_t numModules;
+    uint32_t numFuncs;
+    uint32_t numBBs;
+    uint32_t numImplied;
+    uint32_t pad;
+    uint64_t modulesOffset;
+    uint64_t funcsOffset;
+    uint64_t bbsOffset;
+    uint64_t impliedOffset;
+    uint64_t stringsOffset;
+    uint64_t stringsSize;
+    uint64_t countsOffset;
+};
+
+struct ccovModule {
+    uint32_t nameOffset;
+    uint32_t pad;
+};
+
+struct ccovFunc {
+    uint32_t nameOffset;
+    uint32_t module;
+};
+
+struct ccovBB {
+    uint32_t funcNameOffset;
+    uint32_t module;
+    uint64_t address;
+};
+
+// A block without a probe of its own (see codeCoverage -d): block id was hit
+// if block target was
+struct ccovImplied {
+    uint32_t id;
+    uint32_t target;
+};
+
+/*
+ * A read-only view of a coverage table in memory
+ */
+class CoverageTable {
+public:
+    CoverageTable(const char *data);
+
+    // Returns true if size bytes at data hold a valid table, followed by
+    // counts if withCounts is set
+    static bool check(const char *data, uint64_t size, bool withCounts);
+
+    const ccovHeader *header() const { return hdr; }
+    uint64_t size() const { return hdr->countsOffset; }
+    size_t numCounts() const { return (size_t)hdr->numFuncs + hdr->numBBs; }
+    bool hitOnly() const { return (hdr->flags & CCOV_HIT_ONLY) != 0; }
+    bool hasBlocks() const { return (hdr->flags & CCOV_BLOCKS) != 0; }
+
+    const char *str(uint32_t offset) const;
+    const ccovFunc &func(uint32_t i) const;
+    const ccovBB &bb(uint32_t i) const;
+    const ccovImplied &implied(uint32_t i) const;
+    const char *funcName(uint32_t i) const;
+    const char *funcModule(uint32_t i) const;
+    const char *bbFuncName(uint32_t i) const;
+    const char *bbModule(uint32_t i) const;
+
+    // True if both tables describe the same instrumented binary
+    bool sameAs(const CoverageTable &other) const;
+
+    // Prints the counts, sorted by count or by name. Only the functions and
+    // blocks that were hit are printed unless printAll is set.
+    void print(FILE *out, const uint64_t *counts, bool printAll,
+               bool printBlocks, bool alphabetical) const;
+
+    // Prints what is covered by only one of counts and baseCounts
+    void printDiff(FILE *out, const uint64_t *counts,
+                   const uint64_t *baseCounts, bool printBlocks) const;
+
+private:
+    const char *data;
+    const ccovHeader *hdr;
+};
+
+/*
+ * Builds a coverage table; used by codeCoverage while instrumenting
+ */
+class CoverageTableBuilder {
+public:
+    CoverageTableBuilder();
+
+    // Each returns the id of the new function or block
+    uint32_t addFunc(const std::string &name, const std::string &module);
+    uint32_t addBB(const std::string &funcName, const std::string &module,
+                   uint64_t address);
+    void addImplied(uint32_t id, uint32_t target);
+
+    uint32_t numFuncs() const { return funcs.size(); }
+    uint32_t numBBs() const { return bbs.size(); }
+
+    // Adds every function, block and implied block of table after the ones
+    // already added, so its ids are offset by the current counts
+    void append(const CoverageTable &table);
+
+    // Returns the table
+    std::string build(uint32_t flags) const;
+
+    // Returns a table of only the functions and blocks added since there
+    // were funcStart functions and bbStart blocks, with ids relative to those
+    std::string buildSince(uint32_t funcStart, uint32_t bbStart,
+                           uint32_t flags) const;
+
+private:
+    uint32_t addString(const std::string &str);
+    uint32_t addModule(const std::string &name);
+
+    std::map<std::string, uint32_t> stringOffsets;
+    std::string strings;
+    std::map<std::string, uint32_t> moduleIds;
+    std::vector<ccovModule> modules;
+    std::vector<ccovFunc> funcs;
+    std::vector<ccovBB> bbs;
+    std::vector<ccovImplied> implied;
+};
+
+#endif
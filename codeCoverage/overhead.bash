@@ -0,0 +1,49 @@
+#!/bin/bash
+#
+# Measures the run time overhead of the codeCoverage instrumentation with the
+# testcc program, at function and basic block granularity, both with calls
+# into libInst and with inline counters (-i).
+#
+# Usage: ./overhead.bash [iterations]
+#
+
+ITERATIONS=${1:-10000000}
+OUTDIR=overhead
+
+function _run
+{
+    # Prints the wall clock seconds taken by one run of the given binary
+    local START=$(date +%s.%N)
+    TESTCC_ITERATIONS=$ITERATIONS $1 1 > /dev/null
+    local END=$(date +%s.%N)
+    echo "$END - $START" | bc
+}
+
+function _measure
+{
+    NAME=$1
+    shift
+
+    mkdir -p $OUTDIR/$NAME
+    ./codeCoverage "$@" ./testcc $OUTDIR/$NAME/testcc.inst > /dev/null 2>&1
+    if [[ $? -ne 0 ]]; then
+        echo "Failed to instrument testcc with $@"
+        return
+    fi
+
+    SECS=$(_run $OUTDIR/$NAME/testcc.inst)
+    printf "%-12s %8.3f s %8.2fx\n" $NAME $SECS $(echo "$SECS / $BASE" | bc -l)
+}
+
+make codeCoverage libInst.so testcc || exit 1
+export LD_LIBRARY_PATH=${LD_LIBRARY_PATH}:.
+
+echo "testcc with $ITERATIONS iterations"
+
+BASE=$(_run ./testcc)
+printf "%-12s %8.3f s %8.2fx\n" none $BASE 1
+
+_measure func-call
+_measure func-inline -i
+_measure bb-call -b
+_measure bb-inline -ib
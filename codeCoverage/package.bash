@@ -5,11 +5,12 @@ function _package
     DEST=$1
 
     make clean
-    make --file=Makefile.afs codeCoverage-static libInst.so testcc
+    make --file=Makefile.afs codeCoverage-static libInst.so ccmerge testcc
     mkdir $DEST
     cp codeCoverage-static $DEST/codeCoverage
     strip $DEST/codeCoverage
     cp libInst.so $DEST
+    cp ccmerge $DEST
     cp ${DYNINST_ROOT}/${PLATFORM}/lib/libdyninstAPI_RT.so.8.0 ${DEST}/libdyninstAPI_RT.so
     cp README.staticdist $DEST/README
     tar czvf $DEST.tgz $DEST
@@ -35,7 +35,16 @@ int main(int argc, char *argv[]) {
         callLib = 1;
     }
 
-    one(callThree, callLib);
+    /* Repeating the calls makes the cost of instrumentation measurable */
+    int iterations = 1;
+    char *iterEnv = getenv("TESTCC_ITERATIONS");
+    if( iterEnv ) {
+        iterations = atoi(iterEnv);
+    }
+
+    for(int i = 0; i < iterations; ++i) {
+        one(callThree, callLib);
+    }
 
     return EXIT_SUCCESS;
 }
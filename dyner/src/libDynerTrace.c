@@ -0,0 +1,136 @@
+/*
+ * See the dyninst/COPYRIGHT file for copyright information.
+ * 
+ * We provide the Paradyn Tools (below described as "Paradyn")
+ * on an AS IS basis, and do not warrant its validity or performance.
+ * We reserve the right to update, modify, or discontinue this
+ * software at any time.  We shall have no obligation to supply such
+ * updates or modifications or any other form of support to you.
+ * 
+ * By your use of Paradyn, you understand and agree that we (or any
+ * other person or entity with proprietary rights in Paradyn) are
+ * under no obligation to provide either maintenance services,
+ * update services, notices of latent defects, or correction of
+ * defects for Paradyn.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*
+ * The runtime library for dyner's "trace output" tracing and timed
+ * profiles. For tracing, dyner loads it into the mutatee, calls
+ * dynerTraceAttach with the name of the shared memory holding the ring
+ * buffer, and then instruments each traced function with calls to
+ * dynerTraceEvent at its entry and exits. "profile ... timed" calls
+ * dynerCycles at the entry and exits of each profiled function.
+ */
+
+#include <stdint.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include "traceBuffer.h"
+
+static traceRing *ring = NULL;
+static traceSlot *slots = NULL;
+static uint64_t mask = 0;
+
+static __thread uint32_t threadId = 0;
+
+/*
+ * Maps the ring buffer in the shared memory object shmName. Returns 0 on
+ * success and -1 on failure.
+ */
+int dynerTraceAttach(const char *shmName)
+{
+   int fd = shm_open(shmName, O_RDWR, 0);
+   if (fd < 0)
+      return -1;
+
+   struct stat st;
+   if (fstat(fd, &st) != 0 || (size_t) st.st_size < sizeof(traceRing)) {
+      close(fd);
+      return -1;
+   }
+
+   void *mem = mmap(NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+   close(fd);
+   if (mem == MAP_FAILED)
+      return -1;
+
+   traceRing *r = (traceRing *) mem;
+   if (sizeof(traceRing) + r->capacity * sizeof(traceSlot) > (size_t) st.st_size) {
+      munmap(mem, st.st_size);
+      return -1;
+   }
+
+   slots = (traceSlot *) (r + 1);
+   mask = r->capacity - 1;
+   __atomic_store_n(&ring, r, __ATOMIC_RELEASE);
+   return 0;
+}
+
+/*
+ * Records a call or return. The cost is a clock read and one compare and
+ * swap; there is no locking and no system call after the first event of
+ * each thread.
+ */
+void dynerTraceEvent(unsigned int event)
+{
+   traceRing *r = __atomic_load_n(&ring, __ATOMIC_ACQUIRE);
+   if (r == NULL)
+      return;
+
+   struct timespec now;
+   clock_gettime(CLOCK_MONOTONIC, &now);
+
+   if (threadId == 0)
+      threadId = (uint32_t) syscall(SYS_gettid);
+
+   uint64_t head = __atomic_load_n(&r->head, __ATOMIC_RELAXED);
+   do {
+      if (head - __atomic_load_n(&r->tail, __ATOMIC_ACQUIRE) >= r->capacity) {
+         __atomic_fetch_add(&r->dropped, 1, __ATOMIC_RELAXED);
+         return;
+      }
+   } while (!__atomic_compare_exchange_n(&r->head, &head, head + 1, 1,
+                                         __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+
+   traceSlot *slot = &slots[head & mask];
+   slot->rec.time = (uint64_t) now.tv_sec * 1000000000ULL + now.tv_nsec;
+   slot->rec.tid = threadId;
+   slot->rec.event = event;
+   __atomic_store_n(&slot->seq, head + 1, __ATOMIC_RELEASE);
+}
+
+/*
+ * Returns the time stamp counter on x86, and the monotonic clock in
+ * nanoseconds elsewhere
+ */
+unsigned long dynerCycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+   unsigned int lo, hi;
+   __asm__ __volatile__ ("rdtsc" : "=a" (lo), "=d" (hi));
+   return ((unsigned long long) hi << 32) | lo;
+#else
+   struct timespec now;
+   clock_gettime(CLOCK_MONOTONIC, &now);
+   return (uint64_t) now.tv_sec * 1000000000ULL + now.tv_nsec;
+#endif
+}
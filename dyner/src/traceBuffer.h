@@ -0,0 +1,101 @@
+/*
+ * See the dyninst/COPYRIGHT file for copyright information.
+ * 
+ * We provide the Paradyn Tools (below described as "Paradyn")
+ * on an AS IS basis, and do not warrant its validity or performance.
+ * We reserve the right to update, modify, or discontinue this
+ * software at any time.  We shall have no obligation to supply such
+ * updates or modifications or any other form of support to you.
+ * 
+ * By your use of Paradyn, you understand and agree that we (or any
+ * other person or entity with proprietary rights in Paradyn) are
+ * under no obligation to provide either maintenance services,
+ * update services, notices of latent defects, or correction of
+ * defects for Paradyn.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*
+ * The formats shared by dyner, the libDynerTrace runtime library and the
+ * traceDecode tool for "trace output" tracing.
+ *
+ * The traced functions call dynerTraceEvent, which appends a record to a
+ * ring buffer in memory shared with dyner. dyner drains the ring into a
+ * trace file from a separate thread, so the mutatee never does I/O.
+ */
+
+#ifndef __TRACEBUFFER__
+#define __TRACEBUFFER__
+
+#include <stdint.h>
+
+#define DYNER_RING_MAGIC   "DYNRNG1"
+#define DYNER_TRACE_MAGIC  "DYNTRC1"
+
+/* The default number of records in the ring buffer, a power of two */
+#define DYNER_RING_RECORDS (1 << 20)
+
+/* One call to or return from a traced function */
+typedef struct {
+   uint64_t time;    /* CLOCK_MONOTONIC, in nanoseconds */
+   uint32_t tid;
+   uint32_t event;   /* function id << 1, or'ed with 1 for a return */
+} traceRecord;
+
+#define TRACE_EVENT(id, isExit)  (((uint32_t) (id) << 1) | ((isExit) ? 1 : 0))
+#define TRACE_EVENT_ID(event)    ((event) >> 1)
+#define TRACE_EVENT_EXIT(event)  ((event) & 1)
+
+/*
+ * A slot of the ring buffer. The writer stores seq last, as the index of the
+ * record plus one, so the reader can tell a complete record from one that is
+ * still being written.
+ */
+typedef struct {
+   uint64_t seq;
+   traceRecord rec;
+} traceSlot;
+
+/*
+ * The ring buffer, followed by <capacity> slots. head is advanced by the
+ * threads of the mutatee and tail by dyner, so they are kept on separate
+ * cache lines. A record is dropped, and counted, when the ring is full.
+ */
+typedef struct {
+   char magic[8];
+   uint64_t capacity;
+   char pad1[48];
+   uint64_t head;
+   uint64_t dropped;
+   char pad2[48];
+   uint64_t tail;
+   char pad3[56];
+} traceRing;
+
+/*
+ * A trace file is this header, numRecords records and then numNames function
+ * names, each terminated by a NUL, indexed by function id.
+ */
+typedef struct {
+   char magic[8];
+   uint64_t pid;
+   uint64_t numRecords;
+   uint64_t dropped;
+   uint64_t namesOffset;
+   uint64_t numNames;
+} traceFileHeader;
+
+#endif
@@ -0,0 +1,104 @@
+#!/bin/bash
+#
+# The dyner performance regression suite. Generates synthetic mutatees with
+# genMutatee at several scales, runs the dyner sessions of bench.tcl against
+# each of them, and collects the per-operation latencies and instrumented
+# run slowdowns in one JSON array, one object per scale.
+#
+# Run from the build directory, after "make dyner genMutatee libDynerTrace.so"
+# (or just "make bench"):
+#    <srcdir>/tests/bench.bash [output file]
+#
+# The output file defaults to bench.json. The suite is configured from the
+# environment:
+#    BENCH_SCALES       the numbers of functions (default "10 100 1000 10000 100000")
+#    BENCH_DEPTH        the depth of the call chains (default 20)
+#    BENCH_THREADS      the number of threads of the mutatees (default 4)
+#    BENCH_CALLS        function calls per thread in a timed run (default 20000000)
+#    BENCH_TRACE_CALLS  function calls per thread in the traced run (default 1000000)
+#    BENCH_HITS         breakpoint round trips to time (default 200)
+#
+# The mutatees are kept in bench/ and only generated when missing, since
+# compiling the largest one takes a few minutes.
+#
+
+SRCDIR=$(dirname "$0")
+OUTPUT=${1:-bench.json}
+OUTDIR=bench
+
+SCALES=${BENCH_SCALES:-"10 100 1000 10000 100000"}
+DEPTH=${BENCH_DEPTH:-20}
+THREADS=${BENCH_THREADS:-4}
+CALLS=${BENCH_CALLS:-20000000}
+TRACE_CALLS=${BENCH_TRACE_CALLS:-1000000}
+HITS=${BENCH_HITS:-200}
+
+function _iterations
+{
+    # Prints the iterations that make about $1 calls to $2 functions
+    local ITERS=$(( $1 / $2 ))
+    echo $(( ITERS > 0 ? ITERS : 1 ))
+}
+
+function _run
+{
+    # Prints the wall clock microseconds taken by one run of the given command
+    local START=$(date +%s%N)
+    "$@" > /dev/null
+    local END=$(date +%s%N)
+    echo $(( (END - START) / 1000 ))
+}
+
+for PROG in ./dyner ./genMutatee ./libDynerTrace.so; do
+    if [[ ! -e $PROG ]]; then
+        echo "$PROG is missing, run \"make dyner genMutatee libDynerTrace.so\" first"
+        exit 1
+    fi
+done
+
+mkdir -p $OUTDIR
+echo "[" > $OUTPUT
+
+FIRST=1
+for FUNCS in $SCALES; do
+    NAME=bench_${FUNCS}_${DEPTH}_${THREADS}
+    MUTATEE=$OUTDIR/$NAME
+
+    if [[ ! -x $MUTATEE ]]; then
+        echo "Generating $NAME"
+        ./genMutatee $FUNCS $DEPTH $THREADS > $MUTATEE.c &&
+            gcc -g -O1 -fno-optimize-sibling-calls -pthread -o $MUTATEE $MUTATEE.c
+        if [[ $? -ne 0 ]]; then
+            echo "Failed to build $NAME"
+            rm -f $MUTATEE
+            continue
+        fi
+    fi
+
+    ITERS=$(_iterations $CALLS $FUNCS)
+    TRACE_ITERS=$(_iterations $TRACE_CALLS $FUNCS)
+    NATIVE=$(_run $MUTATEE $ITERS)
+
+    echo "Running the dyner sessions on $NAME"
+    rm -f $MUTATEE.json
+    BENCH_MUTATEE=$MUTATEE BENCH_MODULE=$NAME.c BENCH_ITERS=$ITERS \
+        BENCH_TRACE_ITERS=$TRACE_ITERS BENCH_HITS=$HITS BENCH_NATIVE_US=$NATIVE \
+        BENCH_DIR=$OUTDIR BENCH_JSON=$MUTATEE.json \
+        ./dyner -source $SRCDIR/bench.tcl < /dev/null > $MUTATEE.log 2>&1
+    if [[ ! -s $MUTATEE.json ]]; then
+        echo "The dyner sessions on $NAME failed, see $MUTATEE.log"
+        continue
+    fi
+
+    [[ $FIRST -eq 0 ]] && echo "," >> $OUTPUT
+    FIRST=0
+    printf '{\n   "functions": %d,\n   "depth": %d,\n   "threads": %d,\n' \
+        $FUNCS $DEPTH $THREADS >> $OUTPUT
+    printf '   "iterations": %d,\n   "trace_iterations": %d,\n   "native_us": %d,\n' \
+        $ITERS $TRACE_ITERS $NATIVE >> $OUTPUT
+    # The object from bench.tcl, without its opening brace
+    tail -n +2 $MUTATEE.json >> $OUTPUT
+done
+
+echo "]" >> $OUTPUT
+echo "Wrote $OUTPUT"
@@ -0,0 +1,125 @@
+# The dyner sessions of the performance regression suite, run against one
+# synthetic mutatee made by genMutatee. Times each dyner operation and the
+# instrumented runs, and writes the results as a JSON object.
+#
+# bench.bash runs this for every scale; by hand, from the build directory:
+#    BENCH_MUTATEE=<mutatee> BENCH_MODULE=<mutatee source file name> \
+#       ./dyner -source <srcdir>/tests/bench.tcl
+#
+# The other settings, all optional, are taken from the environment:
+#    BENCH_ITERS        iterations of the mutatee in the timed runs
+#    BENCH_TRACE_ITERS  iterations of the mutatee in the traced run
+#    BENCH_HITS         breakpoint round trips to time
+#    BENCH_NATIVE_US    the run time of the mutatee without dyner, for the
+#                       slowdowns
+#    BENCH_DIR          where to put the trace file
+#    BENCH_JSON         the output file (default bench.json)
+
+proc setting {name default} {
+   global env
+   if {[info exists env($name)]} {
+      return $env($name)
+   }
+   return $default
+}
+
+# Runs script in the caller and returns how long it took, in microseconds
+proc timeit {script} {
+   set start [clock microseconds]
+   uplevel 1 $script
+   return [expr {[clock microseconds] - $start}]
+}
+
+set mutatee [setting BENCH_MUTATEE ./bench]
+set module [setting BENCH_MODULE [file tail $mutatee].c]
+set iters [setting BENCH_ITERS 1000]
+set traceIters [setting BENCH_TRACE_ITERS 100]
+set hits [setting BENCH_HITS 200]
+set native [setting BENCH_NATIVE_US 0]
+set dir [setting BENCH_DIR .]
+set jsonFile [setting BENCH_JSON bench.json]
+
+set results [dict create]
+proc record {name value} {
+   global results
+   dict set results $name $value
+}
+
+# Startup, lookups, a single snippet and a lightly instrumented run
+record load_us [timeit {load $mutatee $iters}]
+record index_us [timeit {find function benchTarget}]
+
+set lookups 100
+set total 0
+for {set i 0} {$i < $lookups} {incr i} {
+   incr total [timeit {find function benchTarget}]
+}
+record lookup_us [expr {double($total) / $lookups}]
+
+declare int benchCount
+record at_us [timeit {at benchTarget entry { benchCount++; }}]
+record run_us [timeit {run}]
+
+# Inline counters in every function
+load $mutatee $iters
+record profile_insert_us [timeit {profile $module}]
+record profile_run_us [timeit {run}]
+
+# Entry and exit events of every function into the trace file
+set traceFile [file join $dir [file tail $mutatee].trace]
+load $mutatee $traceIters
+trace output $traceFile
+record trace_insert_us [timeit {trace functions in $module}]
+record trace_run_us [timeit {run}]
+
+# The event counts are in the header of the trace file
+set events 0
+set dropped 0
+if {![catch {open $traceFile rb} f]} {
+   binary scan [read $f 32] a8www magic pid events dropped
+   close $f
+   file delete $traceFile
+}
+record trace_events $events
+record trace_dropped $dropped
+record trace_events_per_sec [expr {$events * 1e6 / max(1, [dict get $results trace_run_us])}]
+
+# Breakpoint round trips
+load $mutatee [expr {$hits + 1}]
+break benchTarget
+run
+
+set times {}
+for {set i 0} {$i < $hits} {incr i} {
+   lappend times [timeit {run}]
+}
+deletebreak 1
+run
+
+set times [lsort -integer $times]
+set total 0
+foreach t $times {
+   incr total $t
+}
+record break_mean_us [expr {double($total) / $hits}]
+record break_median_us [lindex $times [expr {$hits / 2}]]
+record break_max_us [lindex $times end]
+
+# The traced run does fewer iterations than the native one
+if {$native > 0} {
+   set runs [list run $iters profile_run $iters trace_run $traceIters]
+   foreach {run runIters} $runs {
+      set expected [expr {double($native) * $runIters / $iters}]
+      record ${run}_slowdown [expr {[dict get $results ${run}_us] / $expected}]
+   }
+}
+
+set f [open $jsonFile w]
+set fields {}
+dict for {name value} $results {
+   lappend fields [format "   \"%s\": %s" $name $value]
+}
+puts $f "\{\n[join $fields ",\n"]\n\}"
+close $f
+
+exit
@@ -0,0 +1,44 @@
+# Measures the breakpoint round trip latency of dyner: the time from "run"
+# resuming the mutatee to dyner reporting the next breakpoint hit.
+#
+# From the build directory, after "make bpLatency":
+#    ./dyner -source <srcdir>/tests/bpLatency.tcl
+#
+# The number of hits to time is taken from BPLATENCY_HITS (default 1000).
+
+set hits 1000
+if {[info exists env(BPLATENCY_HITS)]} {
+   set hits $env(BPLATENCY_HITS)
+}
+
+load ./bpLatency [expr {$hits + 1}]
+break bpTarget
+
+# The first stop also includes starting the program
+run
+
+set times {}
+for {set i 0} {$i < $hits} {incr i} {
+   set start [clock microseconds]
+   run
+   lappend times [expr {[clock microseconds] - $start}]
+}
+
+# Let the mutatee finish
+deletebreak 1
+run
+
+set total 0
+foreach t $times {
+   incr total $t
+}
+set times [lsort -integer $times]
+
+puts ""
+puts "Breakpoint round trip over $hits hits:"
+puts [format "   mean   %8.1f us" [expr {double($total) / $hits}]]
+puts [format "   median %8d us" [lindex $times [expr {$hits / 2}]]]
+puts [format "   min    %8d us" [lindex $times 0]]
+puts [format "   max    %8d us" [lindex $times end]]
+
+exit
@@ -0,0 +1,117 @@
+/*
+ * See the dyninst/COPYRIGHT file for copyright information.
+ * 
+ * We provide the Paradyn Tools (below described as "Paradyn")
+ * on an AS IS basis, and do not warrant its validity or performance.
+ * We reserve the right to update, modify, or discontinue this
+ * software at any time.  We shall have no obligation to supply such
+ * updates or modifications or any other form of support to you.
+ * 
+ * By your use of Paradyn, you understand and agree that we (or any
+ * other person or entity with proprietary rights in Paradyn) are
+ * under no obligation to provide either maintenance services,
+ * update services, notices of latent defects, or correction of
+ * defects for Paradyn.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*
+ * Writes the C source of a synthetic mutatee for the dyner benchmarks (see
+ * bench.bash) to standard output.
+ *
+ * Usage: genMutatee <functions> [<chain depth> [<threads>]]
+ *
+ * The functions f0 ... f<functions - 1> form call chains of the given depth
+ * (default 20), each function calling the next one in its chain. Every
+ * iteration of run() calls benchTarget once, for the breakpoint benchmark,
+ * and then the head of every chain, so each function is called once per
+ * iteration. main runs run() in the given number of threads (default 1)
+ * for the number of iterations given on the mutatee's command line.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+int main(int argc, char *argv[]) {
+	int n, depth, threads, i;
+
+	if (argc < 2 || argc > 4) {
+		fprintf(stderr, "Usage: %s <functions> [<chain depth> [<threads>]]\n", argv[0]);
+		return 1;
+	}
+
+	n = atoi(argv[1]);
+	depth = (argc > 2 ? atoi(argv[2]) : 20);
+	threads = (argc > 3 ? atoi(argv[3]) : 1);
+	if (n < 1 || depth < 1 || threads < 1) {
+		fprintf(stderr, "%s: the arguments must be positive\n", argv[0]);
+		return 1;
+	}
+
+	printf("/* Generated by genMutatee %d %d %d */\n\n", n, depth, threads);
+	printf("#include <stdio.h>\n");
+	printf("#include <stdlib.h>\n");
+	printf("#include <pthread.h>\n\n");
+	printf("#define THREADS %d\n\n", threads);
+	printf("volatile unsigned long sink;\n\n");
+
+	for (i = 0; i < n; i++)
+		printf("int f%d(int x);\n", i);
+
+	/* Adding to the result keeps the calls from becoming jumps */
+	printf("\n");
+	for (i = 0; i < n; i++) {
+		if (i % depth == depth - 1 || i == n - 1)
+			printf("int __attribute__((noinline)) f%d(int x) { sink += x; return x; }\n", i);
+		else
+			printf("int __attribute__((noinline)) f%d(int x) { sink += x; return f%d(x + 1) + 1; }\n",
+			       i, i + 1);
+	}
+
+	printf("\nint (*heads[])(int) = {");
+	for (i = 0; i < n; i += depth)
+		printf("%s\n\tf%d", i ? "," : "", i);
+	printf("\n};\n\n");
+
+	printf("int __attribute__((noinline)) benchTarget(int i) { return i + 1; }\n\n");
+
+	printf("void *run(void *arg) {\n");
+	printf("\tlong iterations = (long)arg;\n");
+	printf("\tlong i;\n");
+	printf("\tunsigned int h;\n\n");
+	printf("\tfor (i = 0; i < iterations; i++) {\n");
+	printf("\t\tsink += benchTarget(i);\n");
+	printf("\t\tfor (h = 0; h < sizeof(heads) / sizeof(heads[0]); h++)\n");
+	printf("\t\t\tsink += heads[h](i);\n");
+	printf("\t}\n");
+	printf("\treturn NULL;\n");
+	printf("}\n\n");
+
+	printf("int main(int argc, char *argv[]) {\n");
+	printf("\tlong iterations = (argc > 1 ? atol(argv[1]) : 1);\n");
+	printf("\tpthread_t tids[THREADS];\n");
+	printf("\tint t;\n\n");
+	printf("\tfor (t = 1; t < THREADS; t++)\n");
+	printf("\t\tpthread_create(&tids[t], NULL, run, (void *)iterations);\n");
+	printf("\trun((void *)iterations);\n");
+	printf("\tfor (t = 1; t < THREADS; t++)\n");
+	printf("\t\tpthread_join(tids[t], NULL);\n\n");
+	printf("\tprintf(\"Ran %%ld iterations of %d functions in %%d threads\\n\", iterations, THREADS);\n", n);
+	printf("\treturn 0;\n");
+	printf("}\n");
+
+	return 0;
+}
@@ -0,0 +1,97 @@
+/*
+ * See fleece/COPYRIGHT for copyright information.
+ *
+ * This file is a part of Fleece.
+ *
+ * Fleece is free software; you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software; if not, see www.gnu.org/licenses
+*/
+
+#ifndef _COVERAGE_MAP_H_
+#define _COVERAGE_MAP_H_
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#define COVERAGE_MAGIC 0x42464343
+#define COVERAGE_MAP_SIZE (1 << 20)
+#define COVERAGE_LOG_SIZE 4096
+
+/*
+ * The shared memory written by an instrumented decoder library. This layout
+ * must match ccovFeedback in codeCoverage/ccov.h, which also describes how
+ * the map and the log are used.
+ */
+struct CoverageShm {
+   uint32_t magic;
+   uint32_t mapSize;
+   uint32_t nLogged;
+   uint32_t pad;
+   uint32_t log[COVERAGE_LOG_SIZE];
+   unsigned char map[COVERAGE_MAP_SIZE];
+};
+
+/*
+ * Reads block coverage feedback from decoder libraries rewritten by the
+ * codeCoverage tool (in its default, call based mode) and run with
+ * CODECOVERAGE_SHM set to the same name.
+ *
+ * Each slot the instrumentation sets is logged the first time it is hit.
+ * Covered slots are left set, so only blocks no earlier decode reached are
+ * logged, and collecting after a decode only costs as much as the number of
+ * new blocks. The shared memory object is removed when the map is destroyed.
+ */
+class CoverageMap {
+
+public:
+
+   CoverageMap();
+   ~CoverageMap();
+
+   /*
+    * Maps the shared memory object with the given name, creating it if the
+    * instrumentation has not done so yet. Returns 0 on success and -1 on
+    * failure.
+    */
+   int open(const char* name);
+
+   /*
+    * Returns how many slots were hit for the first time since the last call.
+    */
+   unsigned long collect();
+
+   /*
+    * Returns the number of slots hit at least once.
+    */
+   unsigned long getNumCovered() {return nCovered;}
+
+private:
+
+   CoverageShm* shm;
+
+   /*
+    * The name of the shared memory object, unlinked on destruction.
+    */
+   std::string name;
+
+   /*
+    * Nonzero for each slot that has not been hit yet. Only needed when the
+    * log overflows and the whole map has to be scanned.
+    */
+   std::vector<unsigned char> virgin;
+
+   unsigned long nCovered;
+};
+
+#endif /* _COVERAGE_MAP_H_ */
@@ -66,6 +66,7 @@ extern int LLVMInit(void);
 extern int  xed_x86_64_decode     (char*, int, char*, int);
 extern void xed_x86_64_norm       (char*, int);
 
+extern int  dyninst_x86_64_init   (void);
 extern int  dyninst_x86_64_decode (char*, int, char*, int);
 extern void dyninst_x86_64_norm   (char*, int);
 
@@ -0,0 +1,142 @@
+/*
+ * See fleece/COPYRIGHT for copyright information.
+ *
+ * This file is a part of Fleece.
+ *
+ * Fleece is free software; you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software; if not, see www.gnu.org/licenses
+*/
+
+#ifndef _REDUCER_H_
+#define _REDUCER_H_
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Decoder.h"
+#include "ReportingContext.h"
+
+/*
+ * The largest number of bytes a single report entry may contain.
+ */
+#define REDUCER_MAX_BYTES 64
+
+/*
+ * The number of decodings the reducer will cache before it starts over with
+ * an empty cache.
+ */
+#define REDUCER_CACHE_LIMIT (1 << 20)
+
+/*
+ * Shrinks the bytes of each entry in a report file to a minimal trigger. An
+ * entry is only ever changed in ways that keep its disagreement signature
+ * (the template the reporting context uses to suppress duplicate reports), so
+ * the reduced entry still shows the same difference between the decoders.
+ */
+class Reducer {
+
+public:
+
+   /*
+    * Creates a reducer that decodes with the given decoders. The decoders must
+    * be the same (and in the same order) as those used to create the report.
+    */
+   Reducer(std::vector<Decoder>* decoders, bool normalize);
+
+   ~Reducer();
+
+   /*
+    * Reduces every entry of the report file <inName> and writes the reduced
+    * entries to <outf> in the original order. The work is split across
+    * <nJobs> worker processes, since decoders cannot be shared between
+    * threads. Returns 0 on success and -1 on failure.
+    */
+   int reduceReport(const char* inName, FILE* outf, int nJobs);
+
+   /*
+    * Prints data about the activity of the reducer.
+    */
+   void printSummary(FILE* outf);
+
+private:
+
+   /*
+    * Reduces every <nShards>th entry of the report, starting at entry
+    * <shard>, and writes the results to outf followed by a summary line.
+    */
+   void reduceShard(FILE* inf, FILE* outf, int shard, int nShards);
+
+   /*
+    * Shrinks the bytes in place, updating nBytes. Returns false if the bytes
+    * do not produce a disagreement with the current decoders.
+    */
+   bool reduceEntry(char* bytes, int* nBytes);
+
+   /*
+    * Decodes the bytes with every decoder and fills sig with the
+    * disagreement signature. Returns false if all of the decoders agree.
+    */
+   bool getSignature(const char* bytes, int nBytes, std::string& sig);
+
+   /*
+    * Returns true if the bytes produce exactly the given signature.
+    */
+   bool hasSignature(const char* bytes, int nBytes, const std::string& sig);
+
+   /*
+    * Decodes (and normalizes) the bytes with the decoder at index <dec>,
+    * returning a cached decoding if these bytes have been seen before.
+    */
+   const char* decode(int dec, const char* bytes, int nBytes);
+
+   /*
+    * Decodes the bytes with every decoder into decBufs.
+    */
+   void decodeAll(const char* bytes, int nBytes);
+
+   std::vector<Decoder>* decoders;
+   bool norm;
+
+   /*
+    * The reporting context supplies the signatures and writes the reduced
+    * entries.
+    */
+   ReportingContext* repContext;
+
+   /*
+    * Buffers for decoding: a copy of the input bytes (decoders may modify
+    * it), one output buffer per decoder and a buffer for signatures.
+    */
+   char* tempInsn;
+   char** decBufs;
+   char* sigBuf;
+   int sigBufLen;
+
+   /*
+    * Decodings already made, keyed by the decoder index and the bytes.
+    */
+   std::unordered_map<std::string, std::string> decodeCache;
+
+   /*
+    * Data used to summarize the activity of the reducer.
+    */
+   unsigned long nEntries;
+   unsigned long nReduced;
+   unsigned long nSkipped;
+   unsigned long nBytesBefore;
+   unsigned long nBytesAfter;
+   unsigned long nCacheHits;
+   unsigned long nCacheMisses;
+};
+
+#endif /* _REDUCER_H_ */
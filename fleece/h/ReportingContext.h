@@ -5,6 +5,8 @@
 #include "StringUtils.h"
 #include "Alias.h"
 
+class TriageIndex;
+
 /*
  * This class is used to keep track of the instruction templates we have
  * already seen. It filters reports that are similar to the ones we have
@@ -44,13 +46,31 @@ public:
    unsigned int getNumProcessed();
    unsigned int getNumSuppressed();
 
-private:
-   
    /*
     * Reports a difference to the file that was passed at creation time.
     */
    void reportDiff(const char** insns, int nInsns, const char* bytes, int nBytes);
 
+   /*
+    * Returns true if every decoding is equivalent to the first one.
+    */
+   bool doDecodingsMatch(const char** insns, int nInsns);
+
+   /*
+    * Fills buf with the template used to decide if two differences are the
+    * same: each decoding with its hex stripped and register sets replaced,
+    * separated by semicolons. The buffer is always null-terminated.
+    */
+   void makeDiffTemplate(const char** insns, int nInsns, char* buf, int bufLen);
+
+   /*
+    * Every disagreement, including the ones that are not reported, is added
+    * to the triage index if one is set.
+    */
+   void setTriageIndex(TriageIndex* index);
+
+private:
+
    /*
     * Examines the data already reported and decides if the incoming decodings
     * need to be reported as well.
@@ -76,6 +96,11 @@ private:
     */
    std::map<char*, int, StringUtils::str_cmp>* diffMap;
 
+   /*
+    * The triage index to add disagreements to (may be NULL).
+    */
+   TriageIndex* triageIndex;
+
    /*
     * The output file for all reports (but not necessarily for summary data).
     */
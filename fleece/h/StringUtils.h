@@ -114,6 +114,12 @@ void removeTrailing(char* buf, int bufLen, const char* str);
 
 void removeOperand(std::string& str, const std::string& op, const std::string& operand);
 
+/*
+ * Removes the first instance of <operand>, and the ", " after it if the
+ * operand was followed by another.
+ */
+void eraseOperand(std::string& str, const std::string& operand);
+
 /*
  * Removes a substring of length <len> starting at the first character of the
  * first instance of <substr>.
@@ -0,0 +1,130 @@
+/*
+ * See fleece/COPYRIGHT for copyright information.
+ *
+ * This file is a part of Fleece.
+ *
+ * Fleece is free software; you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software; if not, see www.gnu.org/licenses
+*/
+
+#ifndef _TRIAGE_INDEX_H_
+#define _TRIAGE_INDEX_H_
+
+#include <map>
+#include <string>
+#include <vector>
+#include "Decoder.h"
+
+/*
+ * The first bytes of every triage index file.
+ */
+#define TRIAGE_INDEX_MAGIC "FLCTRI1"
+
+/*
+ * The default number of example reports kept for each cluster.
+ */
+#define TRIAGE_DEFAULT_EXEMPLARS 5
+
+/*
+ * Groups disagreements between pairs of decoders into clusters by the shape
+ * of the disagreement, such as a mnemonic mismatch, a different operand
+ * count, a difference at one operand position (with the kind of operand), an
+ * error from only one decoder or a difference in the number of bytes used.
+ *
+ * Each cluster is identified by a key of the form
+ *
+ *    <decoder pair>\t<mnemonic>\t<shape>
+ *
+ * where the decoder names in the pair are sorted, and keeps a count and up to
+ * k exemplar report lines. The index is written as a sorted array of fixed
+ * size records followed by a string table, so a query only needs to map the
+ * file and binary search it.
+ */
+class TriageIndex {
+
+public:
+
+   /*
+    * Creates an empty index for reports made by the given decoders, keeping
+    * up to nExemplars example lines per cluster. If <lengths> is true, the
+    * number of bytes used by each decoder is compared as well (this requires
+    * mapping the instruction, so it is much slower).
+    */
+   TriageIndex(std::vector<Decoder>* decoders, unsigned int nExemplars,
+         bool lengths);
+
+   /*
+    * Adds the set of decodings of one instruction to the index.
+    */
+   void addDecodings(const char** insns, int nInsns, const char* bytes,
+         int nBytes);
+
+   /*
+    * Adds every entry of a report file, or every cluster of a previously
+    * written index file, to the index. Returns 0 on success and -1 on failure.
+    */
+   int addFile(const char* filename);
+
+   /*
+    * Writes the index to a file. Returns 0 on success and -1 on failure.
+    */
+   int write(const char* filename);
+
+   /*
+    * Prints data about the contents of the index.
+    */
+   void printSummary(FILE* outf);
+
+   /*
+    * Prints every cluster of an index file that matches the query. Any of
+    * pair ("gnu,llvm" in either order), mnemonic and shape (a prefix such as
+    * "imm-sign" or "operand-count") may be NULL to match everything. Returns
+    * the number of matching clusters or -1 on failure.
+    */
+   static int query(const char* filename, const char* pair,
+         const char* mnemonic, const char* shape, FILE* outf);
+
+private:
+
+   struct Cluster {
+      unsigned long count;
+      std::vector<std::string> exemplars;
+   };
+
+   /*
+    * Adds <count> reports with the given exemplar to the cluster for key.
+    */
+   void addToCluster(const std::string& key, unsigned long count,
+         const std::string& exemplar);
+
+   /*
+    * Adds the clusters of an index file. Returns 0 on success.
+    */
+   int addIndexFile(const char* filename);
+
+   /*
+    * Adds the entries of a report file. Returns 0 on success.
+    */
+   int addReportFile(const char* filename);
+
+   std::vector<Decoder>* decoders;
+   unsigned int nExemplars;
+   bool lengths;
+
+   std::map<std::string, Cluster> clusters;
+
+   unsigned long nAdded;
+   unsigned long nSkipped;
+};
+
+#endif /* _TRIAGE_INDEX_H_ */
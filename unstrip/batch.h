@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 1996-2011 Barton P. Miller
+ * 
+ * We provide the Paradyn Parallel Performance Tools (below
+ * described as "Paradyn") on an AS IS basis, and do not warrant its
+ * validity or performance.  We reserve the right to update, modify,
+ * or discontinue this software at any time.  We shall have no
+ * obligation to supply such updates or modifications or any other
+ * form of support to you.
+ * 
+ * By your use of Paradyn, you understand and agree that we (or any
+ * other person or entity with proprietary rights in Paradyn) are
+ * under no obligation to provide either maintenance services,
+ * update services, notices of latent defects, or correction of
+ * defects for Paradyn.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+
+
+#ifndef __BATCH_H__
+#define __BATCH_H__
+
+#include <stdio.h>
+
+#include <string>
+#include <vector>
+
+#include "database.h"
+
+using namespace std;
+
+/* 
+ * Runs unstrip over many binaries with one copy of the databases. Each
+ * binary is handled by a child process forked from the driver, so the
+ * databases are loaded once and shared, a failure in one binary does not
+ * stop the others, and the address space of each child can be limited.
+ */
+class BatchDriver {
+    public:
+        /* Fingerprints binFile and writes the relabeled binary to outFile,
+         * listing the identified functions in manifest. Returns 0 on
+         * success. Runs in the child process. */
+        typedef int (*ProcessFunc)(Database & db, 
+                const char * binFile, 
+                const char * outFile,
+                FILE * manifest);
+
+        /* Up to nJobs binaries are processed at once, sharing a budget of
+         * memBudget megabytes of address space (0 for no limit) */
+        BatchDriver(Database & _db, string _outDir, string _manifestFile,
+                int _nJobs, long _memBudget);
+
+        /* Process every file in the directory input, or every file listed
+         * (one per line) in the file input. Returns 0 if all succeeded. */
+        int run(const char * input, ProcessFunc process);
+
+    private:
+        struct Entry {
+            string binFile;
+            string outFile;
+            string partFile;        // functions identified, written by the child
+            unsigned long long hash;
+            int original;           // entry with the same contents, or -1
+            pid_t pid;
+            bool ok;
+            double started;
+            double seconds;
+        };
+
+        bool collectInputs(const char * input, vector<string> & inputs);
+
+        void start(Entry & entry, ProcessFunc process);
+
+        void writeManifest(FILE * out);
+
+        Database & db;
+        string outDir;
+        string manifestFile;
+        int nJobs;
+        long memBudget;
+
+        vector<Entry> entries;
+};
+
+#endif
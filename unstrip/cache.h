@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 1996-2011 Barton P. Miller
+ * 
+ * We provide the Paradyn Parallel Performance Tools (below
+ * described as "Paradyn") on an AS IS basis, and do not warrant its
+ * validity or performance.  We reserve the right to update, modify,
+ * or discontinue this software at any time.  We shall have no
+ * obligation to supply such updates or modifications or any other
+ * form of support to you.
+ * 
+ * By your use of Paradyn, you understand and agree that we (or any
+ * other person or entity with proprietary rights in Paradyn) are
+ * under no obligation to provide either maintenance services,
+ * update services, notices of latent defects, or correction of
+ * defects for Paradyn.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+
+
+#ifndef __CACHE_H__
+#define __CACHE_H__
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "types.h"
+
+using namespace std;
+
+/* 
+ * A persistent cache of fingerprinting results, keyed by a hash of a wrapper
+ * function's code (see Fingerprint::hashFunctions). Each entry holds the
+ * formatted semantic descriptor and the names it matched. The cache lives in
+ * a text file; saving merges with whatever other processes saved in the
+ * meantime and drops the least recently used entries beyond capacity.
+ */
+class ResultCache {
+    public:
+        ResultCache(string _fileName, unsigned _capacity) :
+            hits(0), 
+            misses(0),
+            fileName(_fileName), 
+            capacity(_capacity) {}
+
+        /* Read the cache file; a missing file is an empty cache */
+        bool load();
+
+        /* Merge this cache into the cache file */
+        bool save();
+
+        bool lookup(unsigned long long key, string & tuple, Matches & matches);
+
+        void store(unsigned long long key, string & tuple, Matches & matches);
+
+        unsigned long hits;
+        unsigned long misses;
+
+    private:
+        struct Entry {
+            unsigned long long lastUse;     // microseconds since the epoch
+            bool touched;                   // used or added since loading
+            string tuple;
+            vector<string> names;
+        };
+
+        typedef map<unsigned long long, Entry> EntryMap;
+
+        bool read(EntryMap & into);
+
+        string fileName;
+        unsigned capacity;
+        EntryMap entries;
+};
+
+#endif
@@ -83,27 +83,56 @@ class SyscallNumbersDatabase {
         map<int, string> db;
 };
 
+/* 
+ * The system calls made by a descriptor, as (name id, element position)
+ * pairs sorted by name id. Name ids index the database's name table.
+ */
+typedef vector<pair<int, int> > DescriptorSignature;
+
 class DescriptorDatabase {
     friend class Database;
    
     public:
-        DescriptorDatabase() {}
+        DescriptorDatabase() : spDB(NULL) {}
         
         DescriptorDatabase(SyscallParamDatabase * sp) : spDB(sp) {}
         
-        typedef map<SemanticDescriptor, string>::iterator iterator;
+        typedef vector<pair<SemanticDescriptor, string> >::iterator iterator;
         
-        void insert(pair<SemanticDescriptor, string> val) { db.insert(val); }
+        void insert(pair<SemanticDescriptor, string> val);
 
         bool build();
 
         iterator begin() { return db.begin(); }
         iterator end() { return db.end(); }
+        int size() { return db.size(); }
+
+        pair<SemanticDescriptor, string> & operator[](const int id) { return db[id]; }
+
+        DescriptorSignature & signature(int id) { return signatures[id]; }
+
+        /* Returns the id of a system call name, or -1 if no descriptor in
+         * the database makes that call */
+        int nameId(const char * name);
+
+        /* Ids of the descriptors that make the system call with the given
+         * name id, in ascending order */
+        vector<int> & postings(int nameId) { return index[nameId]; }
+
+        /* Ids of the descriptors that make no system calls */
+        vector<int> & emptyDescriptors() { return empty; }
 
     private:
         SemanticDescriptorElem process(char * _trapVector);
         
-        map<SemanticDescriptor, string> db;
+        vector<pair<SemanticDescriptor, string> > db;
+        vector<DescriptorSignature> signatures;
+
+        /* Inverted index from system call name to descriptors */
+        map<string, int> names;
+        vector<vector<int> > index;
+        vector<int> empty;
+
         SyscallParamDatabase * spDB;
 };
 
@@ -112,14 +141,43 @@ class Database {
     friend class Fingerprint;
     
     public:
-        Database() {};
+        Database() : contentHash(0), image(NULL), imageSize(0) {};
 
         bool setup(SymtabAPI::Symtab * symtab, Mode mode, string relPath);
 
+        /* Read the databases without looking at a binary; if useImage is
+         * false the text databases are always read */
+        bool load(Mode mode, string relPath, bool useImage);
+
+        /* Find the address through which the binary makes indirect system
+         * calls; setup does this after load */
+        void locateSyscallTrampStore(SymtabAPI::Symtab * symtab);
+
+        /* Path of the binary image, once load has applied relPath */
+        string imagePath();
+
+        /* Write the parameter, system call number and descriptor databases
+         * to a single binary image that loadImage can map */
+        bool writeImage(string fileName);
+
+        /* Load all three databases from a binary image. Fails if the image
+         * is missing, of another version, or older than the text databases */
+        bool loadImage(string fileName, Mode mode);
+
         DescriptorDatabase dDB; // descriptor database
         SyscallParamDatabase spDB; // syscall param database
         SyscallNumbersDatabase snDB; // syscall numbers database
         Address syscallTrampStore;
+
+        /* Hash of the text databases, set by load; results computed
+         * against one version of the databases are only reused with it */
+        unsigned long long contentHash;
+
+    private:
+        /* The mapped binary image; strings in the databases point into it,
+         * so it stays mapped for the life of the process */
+        void * image;
+        size_t imageSize;
 };
 
 #endif
@@ -34,10 +34,14 @@
 #define __FINGERPRINT_H__
 
 #include <map>
+#include <mutex>
+#include <set>
 #include <stack>
 #include <vector>
 
 #include "database.h"
+#include "threadpool.h"
+#include "cache.h"
 
 using namespace std;
 using namespace Dyninst;
@@ -56,49 +60,146 @@ class Fingerprint {
                 vector<AbsRegion> & regsToSliceFor,
                 stack<ParseAPI::Function *> & callstack,
                 vector<ParamType> & params,
-                SemanticDescriptorElem & curTrap);
+                SemanticDescriptorElem & curTrap,
+                bool & readMemory);
 
-        void processFunc(ParseAPI::Function * f,
-            SymtabAPI::Function * symFunc);
+        /* The analysis of one exported wrapper function, made in parallel
+         * and applied in order afterwards */
+        struct FuncResult {
+            ParseAPI::Function * f;
+            SymtabAPI::Function * symFunc;
+            SemanticDescriptor sd;
+            Matches matches;
+            string tuple;
+            unsigned long long key;     // result cache key
+            bool readsMemory;           // see memoryTraps
+        };
 
-        void identify(ParseAPI::Function * f,
-                SemanticDescriptor & sd,
-                SymtabAPI::Function * symFunc);
+        void processFunc(FuncResult & result);
 
-        void learn(ParseAPI::Function * f, 
-                SemanticDescriptor & sd);
+        void identify(FuncResult & result);
+
+        void learn(vector<FuncResult> & results);
 
         bool parse(ParseAPI::Function * f,
-                stack<ParseAPI::Function *> & callstack,
-                SemanticDescriptor & retSD);
+                ParseAPI::Function * caller,
+                SemanticDescriptor & retSD,
+                bool & readsMemory);
+
+        bool parseTraps(ParseAPI::Function * f,
+                ParseAPI::Function * caller,
+                SemanticDescriptor & sd);
+
+        SemanticDescriptorElem & parseTrap(ParseAPI::Function * f,
+                trapLoc & tloc,
+                ParseAPI::Function * caller);
+
+        bool appendDescriptor(ParseAPI::Function * g,
+                ParseAPI::Function * caller,
+                SemanticDescriptor & calls,
+                bool callsReadMemory,
+                SemanticDescriptor & sd);
+
+        void findCallees(ParseAPI::Function * f,
+                vector<ParseAPI::Function *> & callees);
+
+        void visit(ParseAPI::Function * f,
+                map<ParseAPI::Function *, pair<int, int> > & order,
+                vector<ParseAPI::Function *> & sccStack,
+                set<ParseAPI::Function *> & onStack,
+                vector<set<ParseAPI::Function *> > & components);
+
+        void findComponents(vector<FuncResult *> * results,
+                vector<set<ParseAPI::Function *> > & components);
+
+        void buildComponent(set<ParseAPI::Function *> & component);
+
+        void buildCallGraph();
+
+        void sliceTraps(vector<FuncResult *> & results,
+                vector<set<ParseAPI::Function *> > & components);
+
+        void buildDescriptors(vector<set<ParseAPI::Function *> > & components);
+
+        void hashFunctions(vector<set<ParseAPI::Function *> > & components);
+
+        unsigned long long hashCode(ParseAPI::Function * f,
+                map<ParseAPI::Function *, unsigned long long> * inComponent);
 
         void buildMappings();
 
-        Database db;
+        Database & db;
         Mode mode;
         string relPath; 
         map<ParseAPI::Function *, vector<trapLoc> > trapAddresses;
         set<pair<ParseAPI::Function *, trapLoc> > trapInfo;
+        set<Address> trapSites;
         bool oneSymbol;
         bool verbose;
 
+        /* Wrapper functions called by each wrapper function, in call order */
+        map<ParseAPI::Function *, vector<ParseAPI::Function *> > callGraph;
+
+        /* The part of each function's descriptor that comes from the
+         * functions it calls; the same for every caller of the function */
+        map<ParseAPI::Function *, SemanticDescriptor> calleeDescriptors;
+
+        /* True if calleeDescriptors[f] holds values read from the binary's
+         * data (see memoryTraps) */
+        map<ParseAPI::Function *, bool> calleesReadMemory;
+
+        /* Descriptor elements for traps, keyed by function, trap address and
+         * the caller slicing may follow back into */
+        typedef pair<pair<ParseAPI::Function *, Address>, ParseAPI::Function *> TrapKey;
+        map<TrapKey, SemanticDescriptorElem> trapCache;
+        mutex trapCacheLock;
+
+        /* The traps in trapCache whose elements hold a string or value read
+         * from memory at a constant address. Such data is not covered by
+         * the code hash, so these results are never put in the result cache */
+        set<TrapKey> memoryTraps;
+
+        ThreadPool pool;
+
+        /* Results of earlier runs, keyed by the hash of a function's code
+         * (see hashFunctions) and of the databases; NULL if not used */
+        ResultCache * cache;
+        map<ParseAPI::Function *, unsigned long long> codeHashes;
+
+        /* Functions that were given names, with the names */
+        vector<pair<Address, string> > identified;
+
     public:
-        Fingerprint(Database _db, Mode m, string _relPath, bool _oneSymbol, bool _verbose) : 
+        Fingerprint(Database & _db, Mode m, string _relPath, bool _oneSymbol, bool _verbose,
+                int _nThreads) : 
             db(_db), 
             mode(m), 
             relPath(_relPath), 
             oneSymbol(_oneSymbol),
-            verbose (_verbose)  {}
+            verbose (_verbose),
+            pool(_nThreads),
+            cache(NULL)  {}
+
+        /* Reuse and record results in cache; not used when learning */
+        void setCache(ResultCache * _cache) { 
+            if (mode != _learn) cache = _cache; 
+        }
 
         void addTrapInfo(ParseAPI::Function * f, trapLoc & t) {
             trapInfo.insert(make_pair(f,t));
+            trapSites.insert(t.addr());
         }
+
+        bool hasTrapAt(Address a) { return trapSites.count(a) != 0; }
         
         void findMain(SymtabAPI::Symtab * symtab, 
                 ParseAPI::SymtabCodeSource * sts,
                 SymtabAPI::Module * defmod);
 
         void run(SymtabAPI::Symtab * symtab);
+
+        /* The functions named by run, with the names added to each */
+        vector<pair<Address, string> > & getIdentified() { return identified; }
 };
 
 #endif
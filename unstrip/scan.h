@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 1996-2011 Barton P. Miller
+ * 
+ * We provide the Paradyn Parallel Performance Tools (below
+ * described as "Paradyn") on an AS IS basis, and do not warrant its
+ * validity or performance.  We reserve the right to update, modify,
+ * or discontinue this software at any time.  We shall have no
+ * obligation to supply such updates or modifications or any other
+ * form of support to you.
+ * 
+ * By your use of Paradyn, you understand and agree that we (or any
+ * other person or entity with proprietary rights in Paradyn) are
+ * under no obligation to provide either maintenance services,
+ * update services, notices of latent defects, or correction of
+ * defects for Paradyn.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+
+
+#ifndef __SCAN_H__
+#define __SCAN_H__
+
+#include <set>
+#include <vector>
+
+#include "util.h"
+
+using namespace std;
+using namespace Dyninst;
+
+/* 
+ * Locates system call sites without parsing the whole binary. The code
+ * regions are searched for the byte patterns of int 0x80 (cd 80), syscall
+ * (0f 05), sysenter (0f 34), call *%gs:0x10 (65 ff 15 10 00 00 00) and, once
+ * its address is known, call *_dl_sysinfo (ff 15 <addr>). Each candidate is
+ * decoded to confirm it is a system call, and the entry of the function that
+ * contains it is looked for among the direct call targets, so only those
+ * functions need to be parsed. Since the patterns also occur inside other
+ * instructions, a site is only taken as real once parsing finds an
+ * instruction starting at it (see checkSite).
+ */
+class SyscallScanner {
+    public:
+        /* A candidate system call site, with the entry of the function that
+         * contains it, or 0 if no call target qualified */
+        struct Site {
+            Address addr;
+            Address entry;
+            ParseAPI::CodeRegion * region;
+        };
+
+        enum SiteStatus {
+            SITE_CONFIRMED,     // an instruction of a parsed block starts there
+            SITE_INSIDE_INSN,   // inside a parsed instruction: a false hit
+            SITE_UNPARSED       // not in any parsed block
+        };
+
+        SyscallScanner(ParseAPI::CodeSource * _cs, Address _syscallTrampStore) :
+            cs(_cs), syscallTrampStore(_syscallTrampStore) {}
+
+        /* Find the system call sites that decode as such, and the entries
+         * of the functions that contain them */
+        void scan(vector<Site> & sites);
+
+        /* Check site against the code parsed so far */
+        static SiteStatus checkSite(ParseAPI::CodeObject * co, 
+                const Site & site);
+
+        /* Offsets in buf of bytes that start a system call pattern */
+        static void findCandidates(const unsigned char * buf, 
+                size_t len, 
+                Address syscallTrampStore,
+                vector<size_t> & offsets);
+
+    private:
+        void findCallTargets(ParseAPI::CodeRegion * region,
+                set<Address> & targets);
+
+        Address findEntry(ParseAPI::CodeRegion * region,
+                set<Address> & targets,
+                Address site);
+
+        ParseAPI::CodeSource * cs;
+        Address syscallTrampStore;
+};
+
+#endif
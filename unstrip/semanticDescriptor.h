@@ -58,16 +58,16 @@ class SemanticDescriptorElem {
 
         bool equals(SemanticDescriptorElem & e2, Database & db);
         
+        /* Orders elements by system call name. This must be a strict weak
+         * ordering: equal names compare false in both directions. */
         bool operator<(const SemanticDescriptorElem & e2) const {
-            if (elem.size() == 0) return true;
             if (e2.elem.size() == 0) return false;
+            if (elem.size() == 0) return true;
 
             char * val1 = (char*)elem[0];
             char * val2 = (char*)(e2.elem[0]);
 
-            int ret = strcmp(val1, val2);
-            if (ret <= 0) return true;
-            else return false;
+            return strcmp(val1, val2) < 0;
         }
 
         void * operator[](const int i) const {
@@ -92,6 +92,7 @@ class SemanticDescriptor {
         iterator begin() { return _sd.begin(); }
         iterator end() { return _sd.end(); }
 
+        SemanticDescriptorElem & operator[](const int i) { return _sd[i]; }
 
         bool operator<(const SemanticDescriptor & sd2) const {
             return _sd < sd2._sd;
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 1996-2011 Barton P. Miller
+ * 
+ * We provide the Paradyn Parallel Performance Tools (below
+ * described as "Paradyn") on an AS IS basis, and do not warrant its
+ * validity or performance.  We reserve the right to update, modify,
+ * or discontinue this software at any time.  We shall have no
+ * obligation to supply such updates or modifications or any other
+ * form of support to you.
+ * 
+ * By your use of Paradyn, you understand and agree that we (or any
+ * other person or entity with proprietary rights in Paradyn) are
+ * under no obligation to provide either maintenance services,
+ * update services, notices of latent defects, or correction of
+ * defects for Paradyn.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+
+
+#ifndef __THREADPOOL_H__
+#define __THREADPOOL_H__
+
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+using namespace std;
+
+/* 
+ * A fixed set of worker threads that run the iterations of a loop. Each
+ * worker starts with its own share of the iterations and, once that runs out,
+ * steals from the other end of another worker's share, so a few expensive
+ * iterations do not leave the other workers idle.
+ */
+class ThreadPool {
+    public:
+        ThreadPool(int _nThreads) : nThreads(_nThreads < 1 ? 1 : _nThreads) {}
+
+        /* Call body(i) for every i in [0, n) and return once all calls are
+         * done. With one thread, the calls are made in order on the calling
+         * thread. */
+        void parallelFor(size_t n, function<void(size_t)> body);
+
+        int size() { return nThreads; }
+
+    private:
+        struct WorkQueue {
+            mutex lock;
+            deque<size_t> items;
+        };
+
+        bool take(vector<WorkQueue *> & queues, int self, size_t & item);
+
+        void work(vector<WorkQueue *> & queues, int self, 
+                function<void(size_t)> & body);
+
+        int nThreads;
+};
+
+#endif
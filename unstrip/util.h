@@ -80,4 +80,12 @@ Address getSyscallTrampStore(SymtabAPI::Symtab * symtab);
 
 Address searchForSyscallTrampStore(ParseAPI::CodeObject::funclist & procedures);
 
+/* 64-bit FNV-1a hashing; pass the previous hash to continue it */
+#define FNV_OFFSET_BASIS 0xcbf29ce484222325ULL
+
+unsigned long long fnvHash(const void * data, size_t len, 
+        unsigned long long hash = FNV_OFFSET_BASIS);
+
+bool hashFile(const char * fileName, unsigned long long & hash);
+
 #endif